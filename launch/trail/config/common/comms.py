@@ -19,11 +19,26 @@ def auv_modem_ids(number_of_auvs):
     auv_first_modem_id = acomms_modem_id(usv_vehicle_id) + 1
     return range(auv_first_modem_id, auv_first_modem_id + number_of_auvs)
 
+# nominal link parameters, shared by the gobyd link configuration and the link planner
+acomms_slot_seconds=10
+satellite_slot_seconds=1
+max_frame_bytes=128
+
 def acomms_mac_slots(number_of_auvs):
     # one usv
     slots=''
     for i in list(auv_modem_ids(number_of_auvs)):
-        slots += 'slot { src: ' + str(acomms_modem_id(usv_vehicle_id)) + ' slot_seconds: 10 max_frame_bytes: 128 }\n'
-        slots += 'slot { src: ' + str(i) + ' slot_seconds: 10 max_frame_bytes: 128 }\n'
+        slots += mac_slot(acomms_modem_id(usv_vehicle_id), acomms_slot_seconds)
+        slots += mac_slot(i, acomms_slot_seconds)
     return slots
 
+def satellite_mac_slots():
+    # one slot each for the topside (vehicle id 0) and the usv
+    slots=''
+    for i in [0, usv_vehicle_id]:
+        slots += mac_slot(satellite_modem_id(i), satellite_slot_seconds)
+    return slots
+
+def mac_slot(src, slot_seconds):
+    return 'slot { src: ' + str(src) + ' slot_seconds: ' + str(slot_seconds) + ' max_frame_bytes: ' + str(max_frame_bytes) + ' }\n'
+
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# Generates Goby3 protobuf configuration using definitions and text substitution
+# Usage: python3 example.pb.cfg.py app_name
+
+import sys
+import os
+from goby import config
+import common, common.origin, common.comms, common.sim
+
+try:
+    number_of_auvs=int(os.environ['goby3_course_n_auvs'])
+except:
+    config.fail('Must set goby3_course_n_auvs environmental variable, e.g. "goby3_course_n_auvs=10 goby3_course_link_planner <(config/link_planner.pb.cfg.py goby3_course_link_planner)"')
+
+debug_log_file_dir = common.goby3_course_logs_dir+ '/link_planner'
+os.makedirs(debug_log_file_dir, exist_ok=True)
+templates_dir=common.goby3_course_templates_dir
+
+nav_dccl_message='goby3_course.dccl.NavigationReport'
+
+def flow(name, group, link, src, vehicles=1, upstream=[]):
+    block = 'flow { name: "' + name + '" group: "' + group + '" dccl_message: "' + nav_dccl_message + '" link: "' + link + '" src: ' + str(src) + ' vehicles: ' + str(vehicles)
+    for u in upstream:
+        block += ' upstream: "' + u + '"'
+    return block + ' }\n'
+
+# mirrors the intervehicle publications in the usv and auv managers
+usv_acomms_modem_id = common.comms.acomms_modem_id(common.comms.usv_vehicle_id)
+usv_satellite_modem_id = common.comms.satellite_modem_id(common.comms.usv_vehicle_id)
+auv_acomms_flows = ['auv_nav_acomms_' + str(i) for i in common.comms.auv_modem_ids(number_of_auvs)]
+
+flows = flow('usv_nav_acomms', 'goby3_course::usv_nav', 'acomms', usv_acomms_modem_id)
+for name, modem_id in zip(auv_acomms_flows, common.comms.auv_modem_ids(number_of_auvs)):
+    flows += flow(name, 'goby3_course::auv_nav', 'acomms', modem_id)
+flows += flow('usv_nav_satellite', 'goby3_course::usv_nav', 'satellite', usv_satellite_modem_id)
+flows += flow('auv_nav_satellite', 'goby3_course::auv_nav', 'satellite', usv_satellite_modem_id, number_of_auvs, auv_acomms_flows)
+
+app_common = config.template_substitute(templates_dir+'/_app.pb.cfg.in',
+                                        app=common.app,
+                                        tty_verbosity = 'QUIET',
+                                        log_file_dir = debug_log_file_dir,
+                                        log_file_verbosity = 'QUIET',
+                                        warp=common.sim.warp,
+                                        lat_origin=common.origin.lat(),
+                                        lon_origin=common.origin.lon())
+
+if common.app == 'goby3_course_link_planner':
+    print(config.template_substitute(templates_dir+'/link_planner.pb.cfg.in',
+                                     app_block=app_common,
+                                     goby3_course_messages_lib=common.goby3_course_messages_lib,
+                                     acomms_mac_slots=common.comms.acomms_mac_slots(number_of_auvs),
+                                     satellite_mac_slots=common.comms.satellite_mac_slots(),
+                                     flows=flows))
+else:
+    sys.exit('App: {} not defined'.format(common.app))
@@ -32,7 +32,8 @@ interprocess_common = config.template_substitute(templates_dir+'/_interprocess.p
 
 link_satellite_block = config.template_substitute(templates_dir+'/_link_satellite.pb.cfg.in',
                                                   subnet_mask=common.comms.subnet_mask,
-                                                  modem_id=satellite_modem_id)
+                                                  modem_id=satellite_modem_id,
+                                                  mac_slots=common.comms.satellite_mac_slots())
 
 
 if common.app == 'gobyd':    
@@ -54,7 +55,7 @@ elif common.app == 'goby_liaison':
                                      interprocess_block = interprocess_common,
                                      http_port=50000+vehicle_id,
                                      goby3_course_messages_lib=common.goby3_course_messages_lib))
-elif common.app == 'goby3_course_topside_manager':
+elif common.app == 'goby3_course_topside_manager' or common.app == 'goby3_course_topside_manager_multi_thread':
     print(config.template_substitute(templates_dir+'/manager.pb.cfg.in',
                                      app_block=app_common,
                                      interprocess_block = interprocess_common,
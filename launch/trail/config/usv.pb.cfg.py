@@ -36,7 +36,8 @@ interprocess_common = config.template_substitute(templates_dir+'/_interprocess.p
 
 link_satellite_block = config.template_substitute(templates_dir+'/_link_satellite.pb.cfg.in',
                                                   subnet_mask=common.comms.subnet_mask,
-                                                  modem_id=satellite_modem_id)
+                                                  modem_id=satellite_modem_id,
+                                                  mac_slots=common.comms.satellite_mac_slots())
 
 link_acomms_block = config.template_substitute(templates_dir+'/_link_acomms.pb.cfg.in',
                                                subnet_mask=common.comms.subnet_mask,
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Measures the throughput of goby3_course_topside_manager_multi_thread as the number of
+# worker threads and replay streams feeding topside grows, against goby3_course_topside_manager
+# replaying the same reports on a single thread
+
+if [[ "$1" == "-h" || "$1" == "--help" ]]; then
+    echo "Usage: topside_benchmark.sh [reports_per_vehicle, default 1000] [vehicles_per_stream, default 10]"
+    exit;
+fi
+
+reports_per_vehicle=${1:-1000}
+vehicles_per_stream=${2:-10}
+platform=topside_benchmark
+
+# config for either manager: benchmark_cfg <app> <streams> [extra fields]
+function benchmark_cfg()
+{
+    cat <<EOF
+app {
+  name: "$1"
+  glog_config { tty_verbosity: QUIET }
+  geodesy { lat_origin: 21.590491 lon_origin: -159.534166 }
+}
+interprocess { platform: "${platform}" }
+usv_modem_id: 2
+$3
+benchmark {
+  streams: $2
+  vehicles_per_stream: ${vehicles_per_stream}
+  reports_per_vehicle: ${reports_per_vehicle}
+}
+EOF
+}
+
+gobyd <(echo "interprocess { platform: \"${platform}\" }") &
+gobyd_pid=$!
+sleep 1
+
+for streams in 1 4 16; do
+    goby3_course_topside_manager <(benchmark_cfg goby3_course_topside_manager ${streams})
+    for worker_threads in 1 2 4 $(nproc); do
+        goby3_course_topside_manager_multi_thread \
+            <(benchmark_cfg goby3_course_topside_manager_multi_thread ${streams} \
+                            "worker_threads: ${worker_threads}")
+    done
+done
+
+kill ${gobyd_pid}
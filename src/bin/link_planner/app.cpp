@@ -0,0 +1,489 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <dccl/codec.h>
+#include <dccl/dynamic_protobuf_manager.h>
+#include <dccl/option_extensions.pb.h>
+#include <goby/middleware/application/interface.h>
+
+#include "config.pb.h"
+
+using goby::glog;
+using ApplicationBase = goby::middleware::Application<goby3_course::config::LinkPlanner>;
+
+namespace goby3_course
+{
+namespace apps
+{
+// Computes achievable update rates and worst-case age-of-information for each flow of DCCL
+// messages given the MAC cycle of each link. Each source is assumed to send only the newest
+// report for each vehicle (newest_first, max_queue 1): originating vehicles always have fresh
+// data, forwarded flows only the newest report their upstream flow has delivered by the start of
+// the slot. Ages are measured from when the originating vehicle built the report. The actual
+// policy of the topside auv_nav subscription (max_queue 10, oldest first, ack_required) is not
+// modeled, so queueing delay and ack traffic on the satellite link are ignored.
+class LinkPlanner : public ApplicationBase
+{
+  public:
+    LinkPlanner();
+
+  private:
+    void run() override;
+
+    void load_messages();
+    bool upstream_simulated(const config::LinkPlanner::Link& link);
+    void simulate_link(const config::LinkPlanner::Link& link, double duration);
+    void recommend_slots(const config::LinkPlanner::Link& link);
+    void report_end_to_end();
+
+    const config::LinkPlanner::Flow& find_flow(const std::string& flow_name);
+
+  private:
+    struct Delivery
+    {
+        double slot_start;
+        double slot_end;
+        // when the originating vehicle built the report carried
+        double generated;
+    };
+
+    struct FlowResult
+    {
+        // minimum across vehicles
+        double updates_per_second{std::numeric_limits<double>::infinity()};
+        // maximum across vehicles
+        double max_age{0};
+        // link whose capacity sets updates_per_second (this one or an upstream link)
+        std::string binding_link;
+        // for each vehicle, in order
+        std::vector<std::vector<Delivery>> deliveries;
+    };
+
+    ::dccl::Codec codec_;
+    // fully qualified DCCL message name to encoded size (including overhead)
+    std::map<std::string, int> message_bytes_;
+    std::map<std::string, FlowResult> results_;
+};
+} // namespace apps
+} // namespace goby3_course
+
+int main(int argc, char* argv[]) { return goby::run<goby3_course::apps::LinkPlanner>(argc, argv); }
+
+goby3_course::apps::LinkPlanner::LinkPlanner()
+{
+    std::set<std::string> link_names;
+    for (const auto& link : cfg().link())
+    {
+        link_names.insert(link.name());
+        if (link.mac().slot_size() == 0)
+            glog.is_die() && glog << "Link " << link.name() << ": mac must have at least one slot"
+                                  << std::endl;
+
+        for (const auto& slot : link.mac().slot())
+        {
+            if (!slot.has_max_frame_bytes())
+                glog.is_die() && glog << "Link " << link.name() << ": slot for src " << slot.src()
+                                      << " must set max_frame_bytes" << std::endl;
+            if (slot.max_frame_bytes() <= 0 || slot.max_num_frames() <= 0)
+                glog.is_die() && glog << "Link " << link.name() << ": slot for src " << slot.src()
+                                      << " has no capacity" << std::endl;
+            if (slot.slot_seconds() <= 0)
+                glog.is_die() && glog << "Link " << link.name() << ": slot for src " << slot.src()
+                                      << " must have positive slot_seconds" << std::endl;
+        }
+    }
+
+    for (const auto& flow : cfg().flow())
+    {
+        if (!link_names.count(flow.link()))
+            glog.is_die() && glog << "Flow " << flow.name() << ": no link named " << flow.link()
+                                  << std::endl;
+
+        if (flow.upstream_size() > 0)
+        {
+            int upstream_vehicles = 0;
+            for (const auto& upstream : flow.upstream())
+                upstream_vehicles += find_flow(upstream).vehicles();
+            if (upstream_vehicles != flow.vehicles())
+                glog.is_die() && glog << "Flow " << flow.name() << ": vehicles ("
+                                      << flow.vehicles() << ") must equal the sum of the upstream "
+                                      << "flows' vehicles (" << upstream_vehicles << ")"
+                                      << std::endl;
+        }
+    }
+
+    load_messages();
+}
+
+void goby3_course::apps::LinkPlanner::run()
+{
+    // simulate every link over the same span of time, covering the slowest MAC cycle
+    double max_cycle_seconds = 0;
+    for (const auto& link : cfg().link())
+    {
+        double cycle_seconds = 0;
+        for (const auto& slot : link.mac().slot()) cycle_seconds += slot.slot_seconds();
+        max_cycle_seconds = std::max(max_cycle_seconds, cycle_seconds);
+    }
+    double duration = cfg().cycles() * max_cycle_seconds;
+
+    // forwarded flows need the rates of their upstream flows, so simulate those links first
+    std::set<std::string> simulated;
+    while (static_cast<int>(simulated.size()) < cfg().link_size())
+    {
+        bool progress = false;
+        for (const auto& link : cfg().link())
+        {
+            if (simulated.count(link.name()) || !upstream_simulated(link))
+                continue;
+
+            simulate_link(link, duration);
+            recommend_slots(link);
+            simulated.insert(link.name());
+            progress = true;
+        }
+
+        if (!progress)
+            glog.is_die() && glog << "Cyclic upstream definition between links" << std::endl;
+    }
+    report_end_to_end();
+
+    quit();
+}
+
+void goby3_course::apps::LinkPlanner::load_messages()
+{
+    for (const auto& lib : cfg().load_shared_library())
+        ::dccl::DynamicProtobufManager::load_from_shared_lib(lib);
+
+    std::cout << "== DCCL messages ==" << std::endl;
+    for (const auto& flow : cfg().flow())
+    {
+        if (message_bytes_.count(flow.dccl_message()))
+            continue;
+
+        const google::protobuf::Descriptor* desc =
+            ::dccl::DynamicProtobufManager::find_descriptor(flow.dccl_message());
+        if (!desc)
+            glog.is_die() && glog << "No DCCL message named " << flow.dccl_message()
+                                  << " (missing load_shared_library?)" << std::endl;
+
+        codec_.load(desc);
+        int max_size = codec_.max_size(desc);
+        message_bytes_[flow.dccl_message()] = max_size + cfg().message_overhead_bytes();
+
+        std::cout << flow.dccl_message() << ": encoded max size " << max_size
+                  << " bytes (max_bytes: " << desc->options().GetExtension(::dccl::msg).max_bytes()
+                  << ")" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+bool goby3_course::apps::LinkPlanner::upstream_simulated(const config::LinkPlanner::Link& link)
+{
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.link() != link.name())
+            continue;
+        for (const auto& upstream : flow.upstream())
+        {
+            find_flow(upstream);
+            if (!results_.count(upstream))
+                return false;
+        }
+    }
+    return true;
+}
+
+void goby3_course::apps::LinkPlanner::simulate_link(const config::LinkPlanner::Link& link,
+                                                    double duration)
+{
+    struct Report
+    {
+        std::string flow;
+        int bytes;
+        // deliveries of the upstream flow for this vehicle (nullptr if this node originates them)
+        const std::vector<Delivery>* upstream;
+        // index into upstream of the last update sent
+        long last_update;
+        std::vector<Delivery> deliveries;
+
+        // index of the newest update available at time t (-1 if none)
+        long update(double t) const
+        {
+            if (!upstream)
+                return last_update + 1;
+
+            long newest = last_update;
+            while (newest + 1 < static_cast<long>(upstream->size()) &&
+                   (*upstream)[newest + 1].slot_end <= t)
+                ++newest;
+            return newest;
+        }
+
+        double generated(long update, double t) const
+        {
+            return upstream ? (*upstream)[update].generated : t;
+        }
+    };
+
+    // a forwarded report is only as fresh as its slowest upstream flow
+    std::map<std::string, double> upstream_rate;
+    std::map<std::string, std::string> upstream_binding_link;
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.link() != link.name() || flow.upstream_size() == 0)
+            continue;
+        upstream_rate[flow.name()] = std::numeric_limits<double>::infinity();
+        for (const auto& upstream : flow.upstream())
+        {
+            const auto& upstream_result = results_.at(upstream);
+            if (upstream_result.updates_per_second < upstream_rate[flow.name()])
+            {
+                upstream_rate[flow.name()] = upstream_result.updates_per_second;
+                upstream_binding_link[flow.name()] = upstream_result.binding_link;
+            }
+        }
+    }
+
+    // reports queued by each src, served round-robin
+    std::map<int, std::vector<Report>> reports;
+    std::map<int, std::size_t> next_report;
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.link() != link.name())
+            continue;
+
+        // the forwarded vehicles are those of the upstream flows, in order
+        std::vector<const std::vector<Delivery>*> upstream_deliveries;
+        for (const auto& upstream : flow.upstream())
+        {
+            for (const auto& vehicle_deliveries : results_.at(upstream).deliveries)
+                upstream_deliveries.push_back(&vehicle_deliveries);
+        }
+
+        for (int v = 0; v < flow.vehicles(); ++v)
+            reports[flow.src()].push_back(
+                {flow.name(), message_bytes_[flow.dccl_message()],
+                 upstream_deliveries.empty() ? nullptr : upstream_deliveries[v], -1, {}});
+    }
+
+    const auto& slots = link.mac().slot();
+    double cycle_seconds = 0;
+    for (const auto& slot : slots) cycle_seconds += slot.slot_seconds();
+    int cycles = std::ceil(duration / cycle_seconds);
+
+    std::vector<double> slot_bytes_used(slots.size(), 0);
+    for (int c = 0; c < cycles; ++c)
+    {
+        double slot_start = c * cycle_seconds;
+        for (int i = 0, n = slots.size(); i < n; ++i)
+        {
+            const auto& slot = slots.Get(i);
+            double slot_end = slot_start + slot.slot_seconds();
+
+            auto& src_reports = reports[slot.src()];
+            auto& next = next_report[slot.src()];
+            std::vector<int> frames(slot.max_num_frames(), slot.max_frame_bytes());
+            for (std::size_t tried = 0; tried < src_reports.size();
+                 ++tried, next = (next + 1) % src_reports.size())
+            {
+                auto& report = src_reports[next];
+                // frames are built at the start of the slot
+                long update = report.update(slot_start);
+                // nothing new to send for this vehicle
+                if (update <= report.last_update)
+                    continue;
+
+                auto frame_it =
+                    std::find_if(frames.begin(), frames.end(),
+                                 [&](int remaining) { return remaining >= report.bytes; });
+                // slot full: this report goes first in the next slot
+                if (frame_it == frames.end())
+                    break;
+
+                *frame_it -= report.bytes;
+                slot_bytes_used[i] += report.bytes;
+                report.last_update = update;
+                report.deliveries.push_back(
+                    {slot_start, slot_end, report.generated(update, slot_start)});
+            }
+            slot_start = slot_end;
+        }
+    }
+
+    std::cout << "== Link: " << link.name() << " (cycle: " << cycle_seconds << " s) =="
+              << std::endl;
+    for (int i = 0, n = slots.size(); i < n; ++i)
+    {
+        const auto& slot = slots.Get(i);
+        int capacity = slot.max_frame_bytes() * slot.max_num_frames();
+        double used = slot_bytes_used[i] / cycles;
+        std::cout << "slot " << i << " src: " << slot.src() << " (" << slot.slot_seconds()
+                  << " s): " << std::fixed << std::setprecision(1) << used << "/" << capacity
+                  << " bytes, utilization " << 100 * used / capacity << "%" << std::defaultfloat
+                  << std::setprecision(6) << std::endl;
+    }
+
+    for (auto& src_reports_p : reports)
+    {
+        for (auto& report : src_reports_p.second)
+        {
+            auto& result = results_[report.flow];
+            const auto& d = report.deliveries;
+            result.deliveries.push_back(d);
+            if (d.size() < 2)
+            {
+                result.updates_per_second = 0;
+                result.max_age = std::numeric_limits<double>::infinity();
+                continue;
+            }
+
+            result.updates_per_second =
+                std::min(result.updates_per_second, d.size() / (cycles * cycle_seconds));
+
+            // until the next delivery completes, the newest data at the receiver is that carried
+            // by the previous one
+            for (std::size_t k = 1; k < d.size(); ++k)
+                result.max_age = std::max(result.max_age, d[k].slot_end - d[k - 1].generated);
+        }
+    }
+
+    std::map<std::string, double> group_updates_per_second;
+    std::map<std::string, double> group_bytes_per_second;
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.link() != link.name())
+            continue;
+        if (std::none_of(slots.begin(), slots.end(),
+                         [&](const goby::acomms::protobuf::ModemTransmission& slot) {
+                             return slot.src() == flow.src();
+                         }))
+            glog.is_warn() && glog << "Flow " << flow.name() << ": src " << flow.src()
+                                   << " has no slot on link " << link.name() << std::endl;
+
+        auto& result = results_[flow.name()];
+        // within 1% of the upstream rate: the upstream link is the bottleneck
+        if (upstream_rate.count(flow.name()) && upstream_rate[flow.name()] > 0 &&
+            result.updates_per_second >= 0.99 * upstream_rate[flow.name()])
+            result.binding_link = upstream_binding_link[flow.name()];
+        else
+            result.binding_link = link.name();
+
+        std::cout << "flow " << flow.name() << " [" << flow.group() << "] src: " << flow.src()
+                  << ", " << flow.vehicles() << " vehicle(s) x "
+                  << message_bytes_[flow.dccl_message()] << " bytes: ";
+        if (result.updates_per_second > 0)
+            std::cout << "update every " << 1.0 / result.updates_per_second
+                      << " s per vehicle (limited by " << result.binding_link
+                      << "), worst-case age " << result.max_age << " s" << std::endl;
+        else
+            std::cout << "NOT DELIVERED" << std::endl;
+
+        group_updates_per_second[flow.group()] += flow.vehicles() * result.updates_per_second;
+        group_bytes_per_second[flow.group()] += flow.vehicles() * result.updates_per_second *
+                                                message_bytes_[flow.dccl_message()];
+    }
+
+    for (const auto& group_p : group_updates_per_second)
+        std::cout << "group " << group_p.first << ": " << group_p.second << " msg/s, "
+                  << group_bytes_per_second[group_p.first] << " bytes/s" << std::endl;
+    std::cout << std::endl;
+}
+
+void goby3_course::apps::LinkPlanner::recommend_slots(const config::LinkPlanner::Link& link)
+{
+    // bytes each src must send per cycle to deliver every report once
+    std::map<int, std::vector<int>> src_bytes;
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.link() != link.name())
+            continue;
+        for (int v = 0; v < flow.vehicles(); ++v)
+            src_bytes[flow.src()].push_back(message_bytes_[flow.dccl_message()]);
+    }
+
+    // keep at least one slot for each existing src (e.g. for acks), in order of first appearance
+    std::vector<goby::acomms::protobuf::ModemTransmission> template_slots;
+    for (const auto& slot : link.mac().slot())
+    {
+        if (std::none_of(template_slots.begin(), template_slots.end(),
+                         [&](const goby::acomms::protobuf::ModemTransmission& t) {
+                             return t.src() == slot.src();
+                         }))
+            template_slots.push_back(slot);
+    }
+
+    std::cout << "== Recommended slots for link: " << link.name() << " ==" << std::endl;
+    double cycle_seconds = 0;
+    double max_slot_seconds = 0;
+    for (const auto& slot : template_slots)
+    {
+        // first-fit decreasing bin packing of reports into slots
+        auto bytes = src_bytes[slot.src()];
+        std::sort(bytes.begin(), bytes.end(), std::greater<int>());
+        int capacity = slot.max_frame_bytes() * slot.max_num_frames();
+        std::vector<int> slots_remaining;
+        for (int b : bytes)
+        {
+            if (b > capacity)
+                glog.is_die() && glog << "Link " << link.name() << ": message of " << b
+                                      << " bytes does not fit in slot for src " << slot.src()
+                                      << std::endl;
+
+            auto it = std::find_if(slots_remaining.begin(), slots_remaining.end(),
+                                   [&](int remaining) { return remaining >= b; });
+            if (it == slots_remaining.end())
+                slots_remaining.push_back(capacity - b);
+            else
+                *it -= b;
+        }
+
+        int num_slots = std::max<int>(1, slots_remaining.size());
+        for (int i = 0; i < num_slots; ++i)
+        {
+            std::cout << "slot { " << slot.ShortDebugString() << " }" << std::endl;
+            cycle_seconds += slot.slot_seconds();
+        }
+        max_slot_seconds = std::max(max_slot_seconds, slot.slot_seconds());
+    }
+    std::cout << "(cycle: " << cycle_seconds << " s, worst-case age <= "
+              << cycle_seconds + max_slot_seconds << " s)" << std::endl
+              << std::endl;
+}
+
+void goby3_course::apps::LinkPlanner::report_end_to_end()
+{
+    std::cout << "== End-to-end worst-case age ==" << std::endl;
+    for (const auto& flow : cfg().flow())
+    {
+        if (flow.upstream_size() == 0)
+            continue;
+
+        double upstream_age = 0;
+        for (const auto& upstream : flow.upstream())
+            upstream_age = std::max(upstream_age, results_.at(upstream).max_age);
+
+        std::cout << "flow " << flow.name() << " [" << flow.group()
+                  << "]: " << results_.at(flow.name()).max_age << " s (upstream: " << upstream_age
+                  << " s)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+const goby3_course::config::LinkPlanner::Flow&
+goby3_course::apps::LinkPlanner::find_flow(const std::string& flow_name)
+{
+    auto flow_it = std::find_if(
+        cfg().flow().begin(), cfg().flow().end(),
+        [&](const config::LinkPlanner::Flow& flow) { return flow.name() == flow_name; });
+    if (flow_it == cfg().flow().end())
+        glog.is_die() && glog << "No flow named " << flow_name << std::endl;
+    return *flow_it;
+}
@@ -8,6 +8,7 @@
 #include "goby3-course/messages/nav_dccl.pb.h"
 #include "goby3-course/nav/convert.h"
 #include "goby3-course/nav/intervehicle.h"
+#include "goby3-course/nav/link_metrics.h"
 
 using goby::glog;
 namespace si = boost::units::si;
@@ -23,8 +24,12 @@ class AUVManager : public ApplicationBase
     AUVManager();
 
   private:
+    void loop() override;
     void subscribe_our_nav();
     void subscribe_usv_nav();
+
+  private:
+    goby3_course::NavLinkMetrics metrics_;
 };
 } // namespace apps
 } // namespace goby3_course
@@ -32,7 +37,12 @@ class AUVManager : public ApplicationBase
 int main(int argc, char* argv[]) { return goby::run<goby3_course::apps::AUVManager>(argc, argv); }
 
 goby3_course::apps::AUVManager::AUVManager()
+    : ApplicationBase(1.0 / (cfg().metrics_interval() * si::seconds)),
+      metrics_(cfg().app().name())
 {
+    if (cfg().metrics_interval() <= 0)
+        glog.is_die() && glog << "metrics_interval must be positive" << std::endl;
+
     glog.add_group("auv_nav", goby::util::Colors::lt_green);
     glog.add_group("usv_nav", goby::util::Colors::lt_blue);
 
@@ -40,6 +50,11 @@ goby3_course::apps::AUVManager::AUVManager()
     subscribe_usv_nav();
 }
 
+void goby3_course::apps::AUVManager::loop()
+{
+    interprocess().publish<goby3_course::groups::link_metrics>(metrics_.metrics());
+}
+
 void goby3_course::apps::AUVManager::subscribe_our_nav()
 {
     interprocess().subscribe<goby::middleware::frontseat::groups::node_status>(
@@ -53,8 +68,9 @@ void goby3_course::apps::AUVManager::subscribe_our_nav()
                                       << "^^ Converts to DCCL nav: " << dccl_nav.ShortDebugString()
                                       << std::endl;
 
-            intervehicle().publish<goby3_course::groups::auv_nav>(dccl_nav,
-                                                                  goby3_course::nav_publisher());
+            intervehicle().publish<goby3_course::groups::auv_nav>(
+                dccl_nav, goby3_course::nav_publisher(metrics_));
+            metrics_.published(goby3_course::groups::auv_nav, dccl_nav);
         });
 }
 
@@ -77,6 +93,7 @@ void goby3_course::apps::AUVManager::subscribe_usv_nav()
         glog.is_verbose() && glog << group("usv_nav")
                                   << "Received USV DCCL nav: " << dccl_nav.ShortDebugString()
                                   << std::endl;
+        metrics_.received(goby3_course::groups::usv_nav, dccl_nav);
 
         // republish internally on interprocess as Protobuf
         interprocess()
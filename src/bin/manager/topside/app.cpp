@@ -1,13 +1,19 @@
+#include <chrono>
+#include <memory>
+
 #include <goby/middleware/marshalling/protobuf.h>
 // this space intentionally left blank
 #include <goby/middleware/frontseat/groups.h>
+#include <goby/middleware/transport/interthread.h>
 #include <goby/zeromq/application/single_thread.h>
 
 #include "config.pb.h"
 #include "goby3-course/groups.h"
 #include "goby3-course/messages/nav_dccl.pb.h"
+#include "goby3-course/nav/benchmark.h"
 #include "goby3-course/nav/convert.h"
 #include "goby3-course/nav/intervehicle.h"
+#include "goby3-course/nav/link_metrics.h"
 
 using goby::glog;
 namespace si = boost::units::si;
@@ -23,9 +29,22 @@ class TopsideManager : public ApplicationBase
     TopsideManager();
 
   private:
+    void loop() override;
     void subscribe_nav_from_usv();
     void handle_incoming_nav(const goby3_course::dccl::NavigationReport& dccl_nav);
+    void run_benchmark();
+
+  private:
+    goby3_course::NavLinkMetrics metrics_;
+
+    // benchmark only, since SingleThreadApplication has no interthread transporter
+    std::unique_ptr<goby::middleware::InterThreadTransporter> benchmark_interthread_;
+    std::chrono::steady_clock::time_point benchmark_start_;
+    int benchmark_dispatched_{0};
 };
+
+// interthread only: stands in for the multi-threaded manager's per-worker shard groups
+constexpr goby::middleware::Group benchmark_dispatch{"goby3_course::topside_benchmark_dispatch"};
 } // namespace apps
 } // namespace goby3_course
 
@@ -34,54 +53,98 @@ int main(int argc, char* argv[])
     return goby::run<goby3_course::apps::TopsideManager>(argc, argv);
 }
 
-goby3_course::apps::TopsideManager::TopsideManager() { subscribe_nav_from_usv(); }
+goby3_course::apps::TopsideManager::TopsideManager()
+    : ApplicationBase(1.0 / (cfg().metrics_interval() * si::seconds)),
+      metrics_(cfg().app().name())
+{
+    if (cfg().metrics_interval() <= 0)
+        glog.is_die() && glog << "metrics_interval must be positive" << std::endl;
+
+    if (cfg().has_benchmark())
+        run_benchmark();
+    else
+        subscribe_nav_from_usv();
+}
+
+void goby3_course::apps::TopsideManager::loop()
+{
+    interprocess().publish<goby3_course::groups::link_metrics>(metrics_.metrics());
+}
 
 void goby3_course::apps::TopsideManager::subscribe_nav_from_usv()
 {
-    goby::middleware::intervehicle::protobuf::TransporterConfig intervehicle_cfg;
-    intervehicle_cfg.add_publisher_id(cfg().usv_modem_id());
-    {
-        auto& buffer = *intervehicle_cfg.mutable_buffer();
-        buffer.set_ack_required(false);
-        buffer.set_max_queue(1);
-        buffer.set_newest_first(true);
-
-        intervehicle()
-            .subscribe<goby3_course::groups::usv_nav, goby3_course::dccl::NavigationReport>(
-                [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
-                    handle_incoming_nav(dccl_nav);
-                },
-                goby3_course::nav_subscriber(intervehicle_cfg));
-    }
+    auto handle_nav = [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
+        handle_incoming_nav(dccl_nav);
+    };
 
-    {
-        auto& buffer = *intervehicle_cfg.mutable_buffer();
-        buffer.set_ack_required(true);
-        buffer.set_max_queue(10);
-        buffer.set_newest_first(false);
-
-        intervehicle()
-            .subscribe<goby3_course::groups::auv_nav, goby3_course::dccl::NavigationReport>(
-                [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
-                    handle_incoming_nav(dccl_nav);
-                },
-                goby3_course::nav_subscriber(intervehicle_cfg));
-    }
+    intervehicle().subscribe<goby3_course::groups::usv_nav, goby3_course::dccl::NavigationReport>(
+        handle_nav,
+        goby3_course::topside_nav_subscriber(goby3_course::groups::usv_nav, cfg().usv_modem_id()));
+
+    intervehicle().subscribe<goby3_course::groups::auv_nav, goby3_course::dccl::NavigationReport>(
+        handle_nav,
+        goby3_course::topside_nav_subscriber(goby3_course::groups::auv_nav, cfg().usv_modem_id()));
 }
 
 void goby3_course::apps::TopsideManager::handle_incoming_nav(
     const goby3_course::dccl::NavigationReport& dccl_nav)
 {
     glog.is_verbose() && glog << "Received DCCL nav: " << dccl_nav.ShortDebugString() << std::endl;
+    // group is set from the "type" field by the Subscriber
+    metrics_.received(goby3_course::nav_group_function(dccl_nav), dccl_nav);
 
     goby::middleware::frontseat::protobuf::NodeStatus frontseat_nav =
-        nav_convert(dccl_nav, this->geodesy());
-
-    if (cfg().has_vehicle_name_prefix())
-        frontseat_nav.set_name(cfg().vehicle_name_prefix() + frontseat_nav.name());
+        nav_convert(dccl_nav, this->geodesy(), cfg().vehicle_name_prefix());
 
     glog.is_verbose() && glog << "^^ Converts to frontseat NodeStatus: "
                               << frontseat_nav.ShortDebugString() << std::endl;
 
     interprocess().publish<goby::middleware::frontseat::groups::node_status>(frontseat_nav);
 }
+
+// Single threaded baseline for goby3_course_topside_manager_multi_thread. The reports take the
+// same two interthread hops as there (replay to dispatch, dispatch to the handler), but both are
+// polled on this thread. Runs to completion from the constructor.
+void goby3_course::apps::TopsideManager::run_benchmark()
+{
+    using goby3_course::groups::topside_benchmark_replay;
+
+    benchmark_interthread_.reset(new goby::middleware::InterThreadTransporter);
+    benchmark_interthread_
+        ->subscribe<topside_benchmark_replay, goby3_course::dccl::NavigationReport>(
+            [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
+                if (benchmark_dispatched_++ == 0)
+                    benchmark_start_ = std::chrono::steady_clock::now();
+                benchmark_interthread_->publish<benchmark_dispatch>(dccl_nav);
+            });
+    benchmark_interthread_->subscribe<benchmark_dispatch, goby3_course::dccl::NavigationReport>(
+        [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
+            handle_incoming_nav(dccl_nav);
+        });
+
+    const auto& benchmark = cfg().benchmark();
+    int reports = 0;
+    for (int r = 0; r < benchmark.reports_per_vehicle(); ++r)
+    {
+        for (int s = 0; s < benchmark.streams(); ++s)
+        {
+            for (int v = 0; v < benchmark.vehicles_per_stream(); ++v, ++reports)
+            {
+                int vehicle = goby3_course::benchmark_vehicle(benchmark, s, v);
+                benchmark_interthread_->publish<topside_benchmark_replay>(
+                    goby3_course::benchmark_nav(vehicle, r));
+            }
+        }
+        // drain both hops, so the last NodeStatus has been published when this returns
+        while (benchmark_interthread_->poll(std::chrono::seconds(0)) > 0)
+        {
+        }
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - benchmark_start_)
+            .count();
+
+    std::cout << goby3_course::benchmark_summary("single_thread", benchmark, reports, seconds)
+              << std::endl;
+    quit();
+}
@@ -0,0 +1,316 @@
+#include <chrono>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <goby/middleware/marshalling/protobuf.h>
+// this space intentionally left blank
+#include <goby/middleware/frontseat/groups.h>
+#include <goby/zeromq/application/multi_thread.h>
+
+#include "config.pb.h"
+#include "goby3-course/groups.h"
+#include "goby3-course/messages/nav_dccl.pb.h"
+#include "goby3-course/nav/benchmark.h"
+#include "goby3-course/nav/convert.h"
+#include "goby3-course/nav/intervehicle.h"
+#include "goby3-course/nav/link_metrics.h"
+
+using goby::glog;
+namespace si = boost::units::si;
+namespace config = goby3_course::config;
+namespace zeromq = goby::zeromq;
+namespace middleware = goby::middleware;
+
+namespace goby3_course
+{
+namespace apps
+{
+// per-shard interthread groups: all the reports from a given vehicle go to the same worker,
+// preserving their order
+class NavShards
+{
+  public:
+    NavShards(int worker_threads)
+    {
+        for (int i = 0; i < worker_threads; ++i)
+            groups_.emplace_back(new middleware::DynamicGroup(
+                "goby3_course::topside_nav_shard::" + std::to_string(i)));
+    }
+
+    int shard(int vehicle) const { return vehicle % static_cast<int>(groups_.size()); }
+    const middleware::Group& group(int shard) const { return *groups_.at(shard); }
+    const middleware::Group& group_for_vehicle(int vehicle) const { return group(shard(vehicle)); }
+
+  private:
+    std::vector<std::unique_ptr<middleware::DynamicGroup>> groups_;
+};
+
+// published by each worker (its index) once it has subscribed to its shard
+constexpr middleware::Group worker_ready{"goby3_course::topside_worker_ready"};
+constexpr middleware::Group benchmark_shard_complete{
+    "goby3_course::topside_benchmark_shard_complete"};
+
+class TopsideManagerMultiThread
+    : public zeromq::MultiThreadApplication<config::TopsideManagerMultiThread>
+{
+  public:
+    TopsideManagerMultiThread();
+
+  private:
+    void handle_worker_ready(int index);
+    void subscribe_nav_from_usv();
+    void launch_benchmark();
+    void dispatch(const goby3_course::dccl::NavigationReport& dccl_nav);
+    void handle_benchmark_shard_complete(int reports);
+
+  private:
+    NavShards shards_;
+    std::set<int> workers_ready_;
+
+    std::chrono::steady_clock::time_point benchmark_start_;
+    int benchmark_dispatched_{0};
+    int benchmark_shards_remaining_{0};
+    int benchmark_reports_{0};
+};
+
+using WorkerTransporter = zeromq::InterProcessPortal<middleware::InterThreadTransporter>;
+
+// Converts the reports for one shard and publishes them on its own connection to gobyd, so that
+// neither the conversion nor the interprocess publication goes through the main thread. Each
+// vehicle is handled by exactly one worker, so the per-worker link metrics do not overlap.
+class NavWorker : public middleware::Thread<config::TopsideManagerMultiThread, WorkerTransporter>
+{
+  public:
+    NavWorker(const config::TopsideManagerMultiThread& config, int index);
+
+  private:
+    void loop() override;
+    void handle_incoming_nav(const goby3_course::dccl::NavigationReport& dccl_nav);
+
+  private:
+    std::unique_ptr<middleware::InterThreadTransporter> interthread_;
+    std::unique_ptr<WorkerTransporter> interprocess_;
+
+    NavShards shards_;
+    goby::util::UTMGeodesy geodesy_;
+    goby3_course::NavLinkMetrics metrics_;
+
+    int benchmark_expected_reports_{0};
+    int benchmark_reports_{0};
+};
+
+// replays synthetic reports for one stream of vehicles as fast as possible
+class BenchmarkReplay : public middleware::SimpleThread<config::TopsideManagerMultiThread>
+{
+  public:
+    BenchmarkReplay(const config::TopsideManagerMultiThread& config, int index);
+
+  private:
+    void loop() override;
+
+  private:
+    bool complete_{false};
+};
+
+inline goby::zeromq::protobuf::InterProcessPortalConfig
+worker_portal_cfg(const config::TopsideManagerMultiThread& config, int index)
+{
+    auto portal_cfg = config.interprocess();
+    portal_cfg.set_client_name(config.app().name() + "::worker" + std::to_string(index));
+    return portal_cfg;
+}
+
+} // namespace apps
+} // namespace goby3_course
+
+int main(int argc, char* argv[])
+{
+    return goby::run<goby3_course::apps::TopsideManagerMultiThread>(
+        goby::middleware::ProtobufConfigurator<config::TopsideManagerMultiThread>(argc, argv));
+}
+
+// Main thread
+
+goby3_course::apps::TopsideManagerMultiThread::TopsideManagerMultiThread()
+    : shards_(cfg().worker_threads())
+{
+    if (cfg().worker_threads() < 1)
+        glog.is_die() && glog << "worker_threads must be at least 1" << std::endl;
+    // the workers publish their LinkMetrics at this interval
+    if (cfg().metrics_interval() <= 0)
+        glog.is_die() && glog << "metrics_interval must be positive" << std::endl;
+
+    // interthread publications with no subscriber are dropped, so nothing is dispatched until
+    // every worker has subscribed to its shard
+    interthread().subscribe<worker_ready, int>(
+        [this](const int& index) { handle_worker_ready(index); });
+
+    for (int i = 0; i < cfg().worker_threads(); ++i) launch_thread<NavWorker>(i, cfg());
+}
+
+void goby3_course::apps::TopsideManagerMultiThread::handle_worker_ready(int index)
+{
+    workers_ready_.insert(index);
+    if (static_cast<int>(workers_ready_.size()) < cfg().worker_threads())
+        return;
+
+    glog.is_verbose() && glog << "All " << cfg().worker_threads() << " workers ready" << std::endl;
+    if (cfg().has_benchmark())
+        launch_benchmark();
+    else
+        subscribe_nav_from_usv();
+}
+
+void goby3_course::apps::TopsideManagerMultiThread::subscribe_nav_from_usv()
+{
+    auto handle_nav = [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
+        dispatch(dccl_nav);
+    };
+
+    intervehicle().subscribe<goby3_course::groups::usv_nav, goby3_course::dccl::NavigationReport>(
+        handle_nav,
+        goby3_course::topside_nav_subscriber(goby3_course::groups::usv_nav, cfg().usv_modem_id()));
+
+    intervehicle().subscribe<goby3_course::groups::auv_nav, goby3_course::dccl::NavigationReport>(
+        handle_nav,
+        goby3_course::topside_nav_subscriber(goby3_course::groups::auv_nav, cfg().usv_modem_id()));
+}
+
+void goby3_course::apps::TopsideManagerMultiThread::launch_benchmark()
+{
+    // workers with no vehicles assigned never report
+    std::set<int> active_shards;
+    const auto& benchmark = cfg().benchmark();
+    for (int s = 0; s < benchmark.streams(); ++s)
+    {
+        for (int v = 0; v < benchmark.vehicles_per_stream(); ++v)
+            active_shards.insert(shards_.shard(goby3_course::benchmark_vehicle(benchmark, s, v)));
+    }
+    benchmark_shards_remaining_ = active_shards.size();
+
+    // the replay stands in for the intervehicle subscriptions and uses the same dispatch
+    interthread()
+        .subscribe<goby3_course::groups::topside_benchmark_replay,
+                   goby3_course::dccl::NavigationReport>(
+            [this](const goby3_course::dccl::NavigationReport& dccl_nav) { dispatch(dccl_nav); });
+    interthread().subscribe<benchmark_shard_complete, int>(
+        [this](const int& reports) { handle_benchmark_shard_complete(reports); });
+
+    for (int i = 0; i < benchmark.streams(); ++i) launch_thread<BenchmarkReplay>(i, cfg());
+}
+
+// the only per-report work on the main thread: hand off to the worker for this vehicle
+void goby3_course::apps::TopsideManagerMultiThread::dispatch(
+    const goby3_course::dccl::NavigationReport& dccl_nav)
+{
+    if (cfg().has_benchmark() && benchmark_dispatched_++ == 0)
+        benchmark_start_ = std::chrono::steady_clock::now();
+
+    interthread().publish_dynamic(dccl_nav, shards_.group_for_vehicle(dccl_nav.vehicle()));
+}
+
+// each worker reports once its last NodeStatus has been published to gobyd
+void goby3_course::apps::TopsideManagerMultiThread::handle_benchmark_shard_complete(int reports)
+{
+    benchmark_reports_ += reports;
+    if (--benchmark_shards_remaining_ > 0)
+        return;
+
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - benchmark_start_)
+            .count();
+    std::cout << goby3_course::benchmark_summary(
+                     "worker_threads: " + std::to_string(cfg().worker_threads()),
+                     cfg().benchmark(), benchmark_reports_, seconds)
+              << std::endl;
+
+    quit();
+}
+
+// Worker threads
+
+goby3_course::apps::NavWorker::NavWorker(const config::TopsideManagerMultiThread& config,
+                                         int index)
+    : middleware::Thread<config::TopsideManagerMultiThread, WorkerTransporter>(
+          config, 1.0 / (config.metrics_interval() * si::seconds), index),
+      shards_(config.worker_threads()),
+      geodesy_({config.app().geodesy().lat_origin_with_units(),
+                config.app().geodesy().lon_origin_with_units()}),
+      metrics_(worker_portal_cfg(config, index).client_name())
+{
+    interthread_.reset(new middleware::InterThreadTransporter);
+    interprocess_.reset(new WorkerTransporter(*interthread_, worker_portal_cfg(config, index)));
+    this->set_transporter(interprocess_.get());
+
+    if (cfg().has_benchmark())
+    {
+        const auto& benchmark = cfg().benchmark();
+        for (int s = 0; s < benchmark.streams(); ++s)
+        {
+            for (int v = 0; v < benchmark.vehicles_per_stream(); ++v)
+            {
+                if (shards_.shard(goby3_course::benchmark_vehicle(benchmark, s, v)) == index)
+                    benchmark_expected_reports_ += benchmark.reports_per_vehicle();
+            }
+        }
+    }
+
+    interthread_->subscribe_dynamic<goby3_course::dccl::NavigationReport>(
+        [this](const goby3_course::dccl::NavigationReport& dccl_nav) {
+            handle_incoming_nav(dccl_nav);
+        },
+        shards_.group(index));
+
+    interthread_->publish<worker_ready>(index);
+}
+
+void goby3_course::apps::NavWorker::loop()
+{
+    interprocess_->publish<goby3_course::groups::link_metrics>(metrics_.metrics());
+}
+
+void goby3_course::apps::NavWorker::handle_incoming_nav(
+    const goby3_course::dccl::NavigationReport& dccl_nav)
+{
+    glog.is_verbose() && glog << "Received DCCL nav: " << dccl_nav.ShortDebugString() << std::endl;
+    // group is set from the "type" field by the Subscriber
+    metrics_.received(goby3_course::nav_group_function(dccl_nav), dccl_nav);
+
+    goby::middleware::frontseat::protobuf::NodeStatus frontseat_nav =
+        nav_convert(dccl_nav, geodesy_, cfg().vehicle_name_prefix());
+
+    glog.is_verbose() && glog << "^^ Converts to frontseat NodeStatus: "
+                              << frontseat_nav.ShortDebugString() << std::endl;
+
+    interprocess_->publish<goby::middleware::frontseat::groups::node_status>(frontseat_nav);
+
+    if (cfg().has_benchmark() && ++benchmark_reports_ == benchmark_expected_reports_)
+        interthread_->publish<benchmark_shard_complete>(benchmark_reports_);
+}
+
+// Benchmark replay threads
+
+goby3_course::apps::BenchmarkReplay::BenchmarkReplay(
+    const config::TopsideManagerMultiThread& config, int index)
+    : middleware::SimpleThread<config::TopsideManagerMultiThread>(config, 1 * si::hertz, index)
+{
+}
+
+void goby3_course::apps::BenchmarkReplay::loop()
+{
+    if (complete_)
+        return;
+
+    const auto& benchmark = cfg().benchmark();
+    for (int r = 0; r < benchmark.reports_per_vehicle(); ++r)
+    {
+        for (int v = 0; v < benchmark.vehicles_per_stream(); ++v)
+        {
+            int vehicle = goby3_course::benchmark_vehicle(benchmark, index(), v);
+            interthread().publish<goby3_course::groups::topside_benchmark_replay>(
+                goby3_course::benchmark_nav(vehicle, r));
+        }
+    }
+    complete_ = true;
+}
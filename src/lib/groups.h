@@ -10,6 +10,7 @@ namespace groups
 constexpr goby::middleware::Group example{"goby3_course::example"};
 constexpr goby::middleware::Group usv_nav{"goby3_course::usv_nav", 1};
 constexpr goby::middleware::Group auv_nav{"goby3_course::auv_nav", 2};
+constexpr goby::middleware::Group link_metrics{"goby3_course::link_metrics"};
 } // namespace groups
 } // namespace goby3_course
 
@@ -0,0 +1,55 @@
+#ifndef GOBY3_COURSE_SRC_LIB_NAV_BENCHMARK_H
+#define GOBY3_COURSE_SRC_LIB_NAV_BENCHMARK_H
+
+#include <sstream>
+
+#include <goby/middleware/group.h>
+#include <goby/time/system_clock.h>
+
+#include "goby3-course/messages/nav_dccl.pb.h"
+#include "goby3-course/messages/topside_benchmark.pb.h"
+
+namespace goby3_course
+{
+namespace groups
+{
+// interthread only: replayed reports on their way to the topside manager's dispatch
+constexpr goby::middleware::Group topside_benchmark_replay{
+    "goby3_course::topside_benchmark_replay"};
+} // namespace groups
+
+// vehicle id of the v-th vehicle replayed by a stream
+inline int benchmark_vehicle(const protobuf::TopsideBenchmark& benchmark, int stream, int v)
+{
+    return stream * benchmark.vehicles_per_stream() + v + 1;
+}
+
+// synthetic report number r for a vehicle
+inline dccl::NavigationReport benchmark_nav(int vehicle, int r)
+{
+    dccl::NavigationReport dccl_nav;
+    dccl_nav.set_vehicle(vehicle);
+    dccl_nav.set_type(dccl::NavigationReport::AUV);
+    dccl_nav.set_time_with_units(goby::time::SystemClock::now<goby::time::MicroTime>());
+    dccl_nav.set_x(10 * (vehicle % 1000));
+    dccl_nav.set_y(r % 1000);
+    dccl_nav.set_z(-(vehicle % 100));
+    dccl_nav.set_speed_over_ground(1.5);
+    dccl_nav.set_heading(r % 360);
+    return dccl_nav;
+}
+
+inline std::string benchmark_summary(const std::string& app,
+                                     const protobuf::TopsideBenchmark& benchmark, int reports,
+                                     double seconds)
+{
+    std::stringstream ss;
+    ss << app << ", streams: " << benchmark.streams()
+       << ", vehicles_per_stream: " << benchmark.vehicles_per_stream() << ", reports: " << reports
+       << ", seconds: " << seconds << ", reports/s: " << reports / seconds;
+    return ss.str();
+}
+
+} // namespace goby3_course
+
+#endif
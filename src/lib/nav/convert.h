@@ -114,6 +114,17 @@ nav_convert(const dccl::NavigationReport& dccl_nav, const goby::util::UTMGeodesy
     return frontseat_nav;
 }
 
+// as above, adding name_prefix to the front of the name for messages sent to GUIs
+inline goby::middleware::frontseat::protobuf::NodeStatus
+nav_convert(const dccl::NavigationReport& dccl_nav, const goby::util::UTMGeodesy& geodesy,
+            const std::string& name_prefix)
+{
+    goby::middleware::frontseat::protobuf::NodeStatus frontseat_nav =
+        nav_convert(dccl_nav, geodesy);
+    frontseat_nav.set_name(name_prefix + frontseat_nav.name());
+    return frontseat_nav;
+}
+
 } // namespace goby3_course
 
 #endif
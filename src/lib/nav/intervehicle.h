@@ -35,11 +35,16 @@ goby::middleware::Group nav_group_function(const goby3_course::dccl::NavigationR
     }
 }
 
-inline goby::middleware::Publisher<goby3_course::dccl::NavigationReport> nav_publisher()
+using NavPublisher = goby::middleware::Publisher<goby3_course::dccl::NavigationReport>;
+
+// optional callbacks are called when a publication is acknowledged or expires (e.g. queue overflow)
+inline NavPublisher nav_publisher(NavPublisher::acked_func_type acked_func = {},
+                                  NavPublisher::expired_func_type expired_func = {})
 {
-    return goby::middleware::Publisher<goby3_course::dccl::NavigationReport>(
+    return NavPublisher(
         {{}, // empty config
-         std::bind(nav_set_group_function, std::placeholders::_1, std::placeholders::_2)});
+         std::bind(nav_set_group_function, std::placeholders::_1, std::placeholders::_2),
+         acked_func, expired_func});
 }
 
 inline goby::middleware::Subscriber<goby3_course::dccl::NavigationReport>
@@ -52,6 +57,35 @@ nav_subscriber(const goby::middleware::intervehicle::protobuf::TransporterConfig
         {subscriber_cfg, std::bind(nav_group_function, std::placeholders::_1)});
 }
 
+// buffer policies for the topside subscriptions to the navigation forwarded by the USV
+inline goby::middleware::Subscriber<goby3_course::dccl::NavigationReport>
+topside_nav_subscriber(const goby::middleware::Group& group, int usv_modem_id)
+{
+    goby::middleware::intervehicle::protobuf::TransporterConfig intervehicle_cfg;
+    intervehicle_cfg.add_publisher_id(usv_modem_id);
+
+    auto& buffer = *intervehicle_cfg.mutable_buffer();
+    if (group == goby3_course::groups::usv_nav)
+    {
+        buffer.set_ack_required(false);
+        buffer.set_max_queue(1);
+        buffer.set_newest_first(true);
+    }
+    else if (group == goby3_course::groups::auv_nav)
+    {
+        buffer.set_ack_required(true);
+        buffer.set_max_queue(10);
+        buffer.set_newest_first(false);
+    }
+    else
+    {
+        throw(std::runtime_error("Unsupported Group " + std::string(group) +
+                                 " for use with topside navigation subscriptions"));
+    }
+
+    return nav_subscriber(intervehicle_cfg);
+}
+
 } // namespace goby3_course
 
 #endif
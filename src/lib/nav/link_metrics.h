@@ -0,0 +1,132 @@
+#ifndef GOBY3_COURSE_SRC_LIB_NAV_LINK_METRICS_H
+#define GOBY3_COURSE_SRC_LIB_NAV_LINK_METRICS_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include <goby/middleware/marshalling/dccl.h>
+#include <goby/middleware/protobuf/intervehicle.pb.h>
+#include <goby/time/system_clock.h>
+
+#include "goby3-course/messages/link_metrics.pb.h"
+#include "goby3-course/messages/nav_dccl.pb.h"
+#include "goby3-course/nav/intervehicle.h"
+
+namespace goby3_course
+{
+// per-group, per-vehicle counters for NavigationReport traffic over intervehicle
+class NavLinkMetrics
+{
+  public:
+    NavLinkMetrics(const std::string& application) : application_(application) {}
+
+    void published(const goby::middleware::Group& group,
+                   const goby3_course::dccl::NavigationReport& dccl_nav)
+    {
+        auto& peer = counters(group, dccl_nav.vehicle());
+        peer.set_published_messages(peer.published_messages() + 1);
+        peer.set_published_bytes(peer.published_bytes() + encoded_size(dccl_nav));
+    }
+
+    void received(const goby::middleware::Group& group,
+                  const goby3_course::dccl::NavigationReport& dccl_nav)
+    {
+        auto& peer = counters(group, dccl_nav.vehicle());
+        peer.set_received_messages(peer.received_messages() + 1);
+        peer.set_received_bytes(peer.received_bytes() + encoded_size(dccl_nav));
+    }
+
+    // the group is recovered from the "type" field, which has been set by the Publisher
+    void acked(const goby3_course::dccl::NavigationReport& dccl_nav,
+               const goby::middleware::intervehicle::protobuf::AckData& ack)
+    {
+        auto& peer = counters(nav_group_function(dccl_nav), dccl_nav.vehicle());
+        double latency = goby::time::SITime(ack.latency_with_units()).value();
+        peer.set_acked_messages(peer.acked_messages() + 1);
+        peer.set_ack_latency_max(std::max(peer.ack_latency_max(), latency));
+        ack_latency_total_[key(nav_group_function(dccl_nav), dccl_nav.vehicle())] += latency;
+    }
+
+    void expired(const goby3_course::dccl::NavigationReport& dccl_nav,
+                 const goby::middleware::intervehicle::protobuf::ExpireData& expire)
+    {
+        auto& peer = counters(nav_group_function(dccl_nav), dccl_nav.vehicle());
+        if (expire.reason() ==
+            goby::middleware::intervehicle::protobuf::ExpireData::EXPIRED_BUFFER_OVERFLOW)
+            peer.set_dropped_queue_overflow(peer.dropped_queue_overflow() + 1);
+        else
+            peer.set_dropped_other(peer.dropped_other() + 1);
+    }
+
+    goby3_course::protobuf::LinkMetrics metrics() const
+    {
+        goby3_course::protobuf::LinkMetrics metrics;
+        metrics.set_application(application_);
+        metrics.set_time_with_units(goby::time::SystemClock::now<goby::time::MicroTime>());
+        for (const auto& peer_p : peers_)
+        {
+            auto& peer = *metrics.add_peer();
+            peer = peer_p.second;
+            if (peer.acked_messages() > 0)
+                peer.set_ack_latency_mean(ack_latency_total_.at(peer_p.first) /
+                                          peer.acked_messages());
+        }
+        return metrics;
+    }
+
+  private:
+    using Key = std::pair<std::string, int>;
+
+    Key key(const goby::middleware::Group& group, int vehicle) const
+    {
+        return std::make_pair(std::string(group), vehicle);
+    }
+
+    goby3_course::protobuf::LinkMetrics::PeerCounters&
+    counters(const goby::middleware::Group& group, int vehicle)
+    {
+        auto it = peers_.find(key(group, vehicle));
+        if (it == peers_.end())
+        {
+            goby3_course::protobuf::LinkMetrics::PeerCounters peer;
+            peer.set_group(std::string(group));
+            peer.set_vehicle(vehicle);
+            it = peers_.insert(std::make_pair(key(group, vehicle), peer)).first;
+        }
+        return it->second;
+    }
+
+    // encodes with Goby's DCCL serializer, which shares its codec (and locking) with the
+    // intervehicle transporter
+    std::size_t encoded_size(const goby3_course::dccl::NavigationReport& dccl_nav) const
+    {
+        return goby::middleware::SerializerParserHelper<
+                   goby3_course::dccl::NavigationReport,
+                   goby::middleware::MarshallingScheme::DCCL>::serialize(dccl_nav)
+            .size();
+    }
+
+  private:
+    std::string application_;
+    std::map<Key, goby3_course::protobuf::LinkMetrics::PeerCounters> peers_;
+    std::map<Key, double> ack_latency_total_;
+};
+
+// nav_publisher() that records acknowledgments and expirations in metrics
+inline NavPublisher nav_publisher(NavLinkMetrics& metrics)
+{
+    return nav_publisher(
+        [&metrics](const goby3_course::dccl::NavigationReport& dccl_nav,
+                   const goby::middleware::intervehicle::protobuf::AckData& ack) {
+            metrics.acked(dccl_nav, ack);
+        },
+        [&metrics](const goby3_course::dccl::NavigationReport& dccl_nav,
+                   const goby::middleware::intervehicle::protobuf::ExpireData& expire) {
+            metrics.expired(dccl_nav, expire);
+        });
+}
+
+} // namespace goby3_course
+
+#endif